@@ -6,24 +6,36 @@
 
 #pragma once
 #include <algorithm>
-#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
 #include "adt/Dictionary.h"
 
 /**
  * @class DictHash - Hash Table implementation of Dictionary ADT
  *
- * Uses linear probing.
+ * Uses linear probing over a power-of-two table of 2^k buckets. The home
+ * bucket is the top k bits of the hash times 2^64/phi (Fibonacci hashing):
+ * a multiply and a shift, no division, and every bit of the hash affects the
+ * result, so hashers like std::hash<long> that return the key unchanged still
+ * spread strided keys across the table.
  * @tparam KeyType   The index key for the dictionary
  * @tparam ValueType The value type for the dictionary
  * @tparam Hasher    The key hasher. Must support ctor and op(const KeyType&).
+ * @tparam Capacity  0 for a growable table (this specialization), otherwise the
+ *                   fixed maximum number of keys (see the primary template below)
  */
-template <typename KeyType, typename ValueType, typename Hasher=std::hash<KeyType>>
-class DictHash : public Dictionary<KeyType,ValueType> {
+template <typename KeyType, typename ValueType, typename Hasher=std::hash<KeyType>, size_t Capacity=0>
+class DictHash;
+
+template <typename KeyType, typename ValueType, typename Hasher>
+class DictHash<KeyType,ValueType,Hasher,0> : public Dictionary<KeyType,ValueType> {
 public:
     typedef DictHash<KeyType,ValueType,Hasher> DictType;
 
     // Big 5
-    DictHash() : table(nullptr), tablesize(0), currentSize(0) {}
+    DictHash() : table(nullptr), tablesize(0), tablebits(0), currentSize(0) {}
     ~DictHash() {
         delete[] table;
     }
@@ -37,6 +49,7 @@ public:
         if (&other != this) {
             delete[] table;
             tablesize = other.tablesize;
+            tablebits = other.tablebits;
             currentSize = other.currentSize;
             table = new Entry[tablesize];
             for (int i = 0; i < tablesize; i++)
@@ -47,6 +60,7 @@ public:
     DictType& operator=(DictType&& temp) {
         std::swap(table, temp.table);
         std::swap(tablesize, temp.tablesize);
+        std::swap(tablebits, temp.tablebits);
         std::swap(currentSize, temp.currentSize);
         return *this;
     }
@@ -96,6 +110,8 @@ public:
     }
 
     void remove(const KeyType& key) {
+        if (tablesize == 0)
+            return;
         Entry &entry = getBucket(key);
         if (entry.status == ACTIVE) {
             entry.status = DELETED;
@@ -104,6 +120,16 @@ public:
         }
     }
 
+    /**
+     * Remove every key but keep the table, so refilling does not reallocate.
+     * @post  has(key) is false for every key
+     */
+    void clear() {
+        for (size_t i = 0; i < tablesize; i++)
+            table[i] = Entry();
+        currentSize = 0;
+    }
+
     /**
      * Report on current load factor (n/tablesize)
      * @return load factor as a ratio
@@ -174,14 +200,15 @@ private:
     };
     Entry *table;
     size_t tablesize;
+    int tablebits;       // tablesize == 2^tablebits once allocated
     size_t currentSize;  // count of ACTIVE and DELETED buckets
 
     Entry& getBucket(const KeyType &key) const {
         Hasher h;
-        size_t hash = h(key);
         size_t bucket;
         long deleted = -1;
-        for (bucket = hash % tablesize; table[bucket].status != EMPTY; bucket = (bucket+1) % tablesize) {
+        size_t mask = tablesize - 1;
+        for (bucket = home(h(key), tablebits); table[bucket].status != EMPTY; bucket = (bucket+1) & mask) {
             if (table[bucket].status == DELETED) {
                 if (deleted == -1)
                     deleted = bucket;  // we can re-use this one if we need a new bucket
@@ -195,30 +222,14 @@ private:
     }
 
     /**
-     * Check if n is prime.
-     * @param n number to check
-     * @return true if n is prime
-     */
-    static bool isprime(size_t n) {
-        size_t limit = static_cast<size_t>(std::sqrt(n)) + 1;
-        for (int factor = 2; factor < limit; factor += 2)
-            if (n % factor == 0)
-                return false;
-        return true;
-    }
-
-    /**
-     * Next prime number after n.
-     * @param n lower bound (n+1) for prime
-     * @return next prime after n (but minimum is 7)
+     * Home bucket for a hash in a table of 2^bits buckets (Fibonacci hashing).
+     * @param hash hasher output
+     * @param bits log2 of the table size (at least 1)
+     * @return top bits of hash times 2^64/phi
      */
-    static size_t nextprime(size_t n) {
-        if (n < 7)
-            return 7;
-        while (!isprime(n)) {
-            n++;
-        }
-        return n;
+    static size_t home(size_t hash, int bits) {
+        uint64_t mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(mixed >> (64 - bits));
     }
 
     /**
@@ -229,7 +240,8 @@ private:
         if (currentSize * 2 >= tablesize) {
             size_t oldtablesize = tablesize;
             Entry *oldtable = table;
-            tablesize = nextprime(tablesize*2);
+            tablebits = tablesize == 0 ? 3 : tablebits + 1;  // minimum is 8 buckets
+            tablesize = size_t(1) << tablebits;
             table = new Entry[tablesize];
             currentSize = 0;
             for (int i = 0; i < oldtablesize; i++)
@@ -239,3 +251,194 @@ private:
         }
     }
 };
+
+/**
+ * @class DictHash - fixed-capacity Hash Table implementation of Dictionary ADT
+ *
+ * Holds at most Capacity keys in a table stored inline in the object and sized
+ * at compile time (a power of two at least twice Capacity), so it never
+ * allocates or rehashes. Uses linear probing with backward-shift deletion,
+ * so removals leave no DELETED buckets behind to fill the table up.
+ * Adding a new key to a full dictionary throws length_error.
+ * @tparam KeyType   The index key for the dictionary
+ * @tparam ValueType The value type for the dictionary
+ * @tparam Hasher    The key hasher. Must support ctor and op(const KeyType&).
+ * @tparam Capacity  Maximum number of keys
+ */
+template <typename KeyType, typename ValueType, typename Hasher, size_t Capacity>
+class DictHash : public Dictionary<KeyType,ValueType> {
+public:
+    typedef DictHash<KeyType,ValueType,Hasher,Capacity> DictType;
+
+    // Big 5 -- the inline table copies and moves with the object
+    DictHash() : table(), currentSize(0) {}
+    ~DictHash() = default;
+    DictHash(const DictType& other) = default;
+    DictHash(DictType&& temp) = default;
+    DictType& operator=(const DictType& other) = default;
+    DictType& operator=(DictType&& temp) = default;
+
+    bool has(const KeyType& key) const {
+        return table[getBucket(key)].active;
+    }
+
+    void add(const KeyType& key, const ValueType& value) {
+        claim(key).value = value;
+    }
+
+    ValueType& get(const KeyType& key) {
+        return claim(key).value;
+    }
+
+    const ValueType& get(const KeyType& key) const {
+        const Entry &entry = table[getBucket(key)];
+        if (!entry.active)
+            throw std::invalid_argument("not found");
+        return entry.value;
+    }
+
+    void remove(const KeyType& key) {
+        size_t hole = getBucket(key);
+        if (!table[hole].active)
+            return;
+        // shift back any later entry in the run whose home bucket is at or before the hole
+        for (size_t next = (hole+1) & MASK; table[next].active; next = (next+1) & MASK) {
+            size_t home = home_bucket(table[next].key);
+            if (((next - home) & MASK) >= ((next - hole) & MASK)) {
+                table[hole] = std::move(table[next]);
+                hole = next;
+            }
+        }
+        table[hole] = Entry();
+        currentSize--;
+    }
+
+    /**
+     * Report on current load factor (n/tablesize)
+     * @return load factor as a ratio
+     */
+    double loadfactor() const {
+        return static_cast<double>(currentSize) / TABLESIZE;
+    }
+
+    /**
+     * @class DictHash<KeyType,ValueType,Hasher,Capacity>::const_iterator iterator for dictionary
+     * The iteration is in arbitrary order.
+     * The iterator can be dereferenced to get the key and then the key can be used
+     * to lookup the value, if desired, using the get(key) method.
+     */
+    class const_iterator {
+    public:
+        const_iterator(const DictType *dict, size_t current) : dict(dict), current(current) {}
+
+        const KeyType &operator*() const {
+            return dict->table[current].key;
+        }
+
+        const_iterator& operator++() {
+            current++;
+            while (current < TABLESIZE && !dict->table[current].active)
+                current++;
+            return *this;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return dict != other.dict || current != other.current;
+        }
+    private:
+        const DictType *dict;
+        size_t current;
+        friend class DictHash<KeyType,ValueType,Hasher,Capacity>;
+    };
+
+    /**
+     * Begin an iteration through the dictionary (arbitrary order).
+     * @return iterator at the first element
+     */
+    const_iterator begin() const {
+        size_t first = 0;
+        while (first < TABLESIZE && !table[first].active)
+            first++;
+        return const_iterator(this, first);
+    }
+
+    /**
+     * Ending iteration bound.
+     * @return iterator past the last element
+     */
+    const_iterator end() const {
+        return const_iterator(this, TABLESIZE);
+    }
+
+private:
+    /**
+     * Smallest power of two that is at least n.
+     * @param n lower bound for the table size
+     * @param size candidate power of two to start from
+     * @return power of two >= max(n, size)
+     */
+    static constexpr size_t pow2atleast(size_t n, size_t size) {
+        return size >= n ? size : pow2atleast(n, size*2);
+    }
+
+    /**
+     * Base-2 logarithm of a power of two.
+     * @param n power of two
+     * @return k such that 2^k == n
+     */
+    static constexpr int log2of(size_t n) {
+        return n <= 1 ? 0 : 1 + log2of(n/2);
+    }
+
+    static constexpr size_t TABLESIZE = pow2atleast(2*Capacity, 8);  // keeps loadfactor <= 50%
+    static constexpr size_t MASK = TABLESIZE - 1;
+    static constexpr int BITS = log2of(TABLESIZE);
+
+    struct Entry {
+        bool active;
+        KeyType key;
+        ValueType value;
+
+        Entry() : active(false), key(), value() {}
+    };
+    Entry table[TABLESIZE];
+    size_t currentSize;  // count of ACTIVE buckets
+
+    /**
+     * Home bucket of key: the top bits of the hash times 2^64/phi (Fibonacci hashing),
+     * so every bit of the hash counts even when the hasher returns the key unchanged.
+     */
+    static size_t home_bucket(const KeyType &key) {
+        Hasher h;
+        uint64_t mixed = static_cast<uint64_t>(h(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(mixed >> (64 - BITS));
+    }
+
+    /**
+     * Find the bucket holding key, or the empty bucket where it would go.
+     * There is always an empty bucket since Capacity < TABLESIZE.
+     */
+    size_t getBucket(const KeyType &key) const {
+        size_t bucket = home_bucket(key);
+        while (table[bucket].active && !(table[bucket].key == key))
+            bucket = (bucket+1) & MASK;
+        return bucket;
+    }
+
+    /**
+     * Find or create the entry for key.
+     * @throws length_error if key is new and the dictionary is full
+     */
+    Entry& claim(const KeyType &key) {
+        Entry &entry = table[getBucket(key)];
+        if (!entry.active) {
+            if (currentSize == Capacity)
+                throw std::length_error("DictHash full");
+            entry.active = true;
+            entry.key = key;
+            entry.value = ValueType();
+            currentSize++;
+        }
+        return entry;
+    }
+};
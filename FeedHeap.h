@@ -0,0 +1,110 @@
+/**
+ * @file FeedHeap.h - Heap index arithmetic and sifting shared by the news feeds
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstddef>
+#include <utility>
+
+/**
+ * @class FeedHeap - binary min-heap of headlines ordered by staleness
+ *
+ * Base class (CRTP) holding the heap logic; the derived feed owns the storage.
+ * The heap is 1-based: heap[root()] is the least stale headline and heap[0]
+ * is unused. Feed must befriend FeedHeap<Feed> and provide:
+ *   heap       indexable storage of headlines, heap[1..n]
+ *   n          number of headlines in the heap
+ *   locations  dictionary from headline to its heap index, with add()
+ *   weight(h)  staleness of headline h
+ * @tparam Feed  the derived feed class
+ */
+template <typename Feed>
+class FeedHeap {
+protected:
+    void bubble(size_t child) {
+        while (!is_root(child) && before(child, parent(child))) {
+            size_t p = parent(child);
+            swap(child, p);
+            child = p;
+        }
+    }
+
+    void percolate(size_t p) {
+        while (!is_leaf(p)) {
+            size_t child = left(p);
+            if (has_right(p) && before(right(p), child))
+                child = right(p);
+            if (!before(child, p))
+                return;
+            swap(child, p);
+            p = child;
+        }
+    }
+
+    /**
+     * Restore the heap property over the whole heap in O(n).
+     */
+    void heapify() {
+        for (size_t p = parent(feed().n); p >= root(); p--)
+            percolate(p);
+    }
+
+    void swap(size_t i, size_t j) {
+        Feed &f = feed();
+        std::swap(f.heap[i], f.heap[j]);
+        f.locations.add(f.heap[i], i);
+        f.locations.add(f.heap[j], j);
+    }
+
+    bool valid(size_t i) const {
+        return i <= feed().n && i >= root();
+    }
+
+    bool is_root(size_t i) const {
+        return i == root();
+    }
+
+    bool is_leaf(size_t i) const {
+        return !valid(left(i));
+    }
+
+    bool has_right(size_t p) const {
+        return valid(right(p));
+    }
+
+    static size_t root() {
+        return 1;
+    }
+
+    static size_t parent(size_t child) {
+        return child/2;
+    }
+
+    static size_t left(size_t p) {
+        return p*2;
+    }
+
+    static size_t right(size_t p) {
+        return left(p)+1;
+    }
+
+private:
+    Feed &feed() {
+        return static_cast<Feed &>(*this);
+    }
+
+    const Feed &feed() const {
+        return static_cast<const Feed &>(*this);
+    }
+
+    /**
+     * Does heap[i] belong above heap[j]?
+     * @return true if heap[i] is strictly less stale than heap[j]
+     */
+    bool before(size_t i, size_t j) const {
+        const Feed &f = feed();
+        return f.weight(f.heap[i]) < f.weight(f.heap[j]);
+    }
+};
@@ -0,0 +1,120 @@
+/**
+ * @file FixedNewsFeed.h - NewsFeed with compile-time capacity and inline storage
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC2430, Spring 2018"
+ */
+
+#pragma once
+#include <stdexcept>
+#include "FeedHeap.h"
+#include "NewsFeed.h"
+
+/**
+ * @class FixedNewsFeed - NewsFeed holding at most Capacity headlines
+ *
+ * Provides NewsFeed's single-item interface (enqueue, peek, dequeue, empty,
+ * weight, reweight, has, get, begin, end) but not the batch apply(), so it
+ * cannot sit behind a NewsFeedIngest. The heap and the three dictionaries are
+ * stored inline with fixed capacity, so the feed never allocates or rehashes
+ * (beyond what std::string itself does for long text). Meant for small, hot
+ * feeds such as per-section breaking news.
+ *
+ * Unlike NewsFeed, dequeue forgets the headline entirely so that its slots
+ * can be reused. Enqueueing a headline already in the feed replaces its story
+ * and staleness. Enqueueing a new headline into a full feed throws length_error.
+ * @tparam Capacity  maximum number of headlines in the feed at once
+ */
+template <size_t Capacity>
+class FixedNewsFeed : private FeedHeap<FixedNewsFeed<Capacity>> {
+ public:
+  typedef NewsFeed::Headline Headline;
+  typedef NewsFeed::Story Story;
+  typedef NewsFeed::Staleness Staleness;
+  typedef NewsFeed::HeadlineHasher HeadlineHasher;
+  typedef typename DictHash<Headline,Story,HeadlineHasher,Capacity>::const_iterator const_iterator;
+
+  FixedNewsFeed() : n(0) {}
+
+  void enqueue(Headline headline, Story story, Staleness weight) {
+    if (has(headline)) {
+      stories.add(headline, story);
+      reweight(headline, weight);
+      return;
+    }
+    if (n == Capacity)
+      throw std::length_error("enqueue into full feed");
+    stories.add(headline, story);
+    staleness.add(headline, weight);
+    locations.add(headline, n+1);
+    heap[++n] = headline;
+    bubble(n);
+  }
+
+  Headline peek() const {
+    if (empty())
+      throw std::invalid_argument("peek in empty heap");
+    return heap[root()];
+  }
+
+  void dequeue() {
+    if (empty())
+      throw std::invalid_argument("dequeue from empty heap");
+    Headline gone = heap[root()];
+    swap(root(), n--);
+    percolate(root());
+    heap[n+1] = Headline();
+    stories.remove(gone);
+    staleness.remove(gone);
+    locations.remove(gone);
+  }
+
+  bool empty() const {
+    return n == 0;
+  }
+
+  Staleness weight(Headline headline) const {
+    return staleness.get(headline);
+  }
+
+  void reweight(Headline headline, Staleness newWeight) {
+    const auto &map = staleness;
+    Staleness old = map.get(headline);
+    staleness.add(headline, newWeight);
+    const auto &where = locations;
+    size_t loc = where.get(headline);
+    if (newWeight > old)
+      percolate(loc);
+    else
+      bubble(loc);
+  }
+
+  bool has(Headline headline) const {
+    return locations.has(headline);
+  }
+
+  Story get(Headline headline) const {
+    return stories.get(headline);
+  }
+
+  const_iterator begin() const {
+    return stories.begin();
+  }
+
+  const_iterator end() const {
+    return stories.end();
+  }
+
+ private:
+  typedef FeedHeap<FixedNewsFeed<Capacity>> Heap;
+  friend class FeedHeap<FixedNewsFeed<Capacity>>;  // sifts heap[] and keeps locations up to date
+  using Heap::bubble;
+  using Heap::percolate;
+  using Heap::swap;
+  using Heap::root;
+
+  DictHash<Headline, Story, HeadlineHasher, Capacity> stories;
+  DictHash<Headline, Staleness, HeadlineHasher, Capacity> staleness;
+  DictHash<Headline, size_t, HeadlineHasher, Capacity> locations;
+  Headline heap[Capacity+1];  // the +1 is b/c we don't use heap[0]
+  size_t n;
+};
@@ -0,0 +1,106 @@
+/**
+ * @file MPSCQueue.h - Bounded lock-free multi-producer, single-consumer ring buffer
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC2430, Spring 2018"
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @class MPSCQueue - bounded ring buffer for many producers and one consumer
+ *
+ * Each cell carries a sequence number that tells producers and the consumer
+ * whose turn it is, so a push is one CAS on the head plus one release store,
+ * and a pop touches no shared counter at all. Neither side ever blocks; a
+ * full or empty queue is reported by the try_ methods returning false.
+ * @tparam T  element type; must support default construction and move assignment
+ */
+template <typename T>
+class MPSCQueue {
+public:
+    /**
+     * Create an empty queue.
+     * @param capacity  minimum number of slots (rounded up to a power of two)
+     */
+    explicit MPSCQueue(size_t capacity) : head(0), tail(0) {
+        size_t slots = 2;
+        while (slots < capacity)
+            slots *= 2;
+        mask = slots - 1;
+        cells = new Cell[slots];
+        for (size_t i = 0; i < slots; i++)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    ~MPSCQueue() {
+        delete[] cells;
+    }
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    /**
+     * Append an element. Safe to call from any number of threads.
+     * @param datum  value to move into the queue (left untouched on failure)
+     * @return       false if the queue is full
+     */
+    bool try_push(T&& datum) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            long diff = static_cast<long>(seq) - static_cast<long>(pos);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = std::move(datum);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // consumer has not freed this slot yet
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Remove the oldest element. Only one thread may call this.
+     * @param datum  receives the element
+     * @return       false if the queue is empty
+     */
+    bool try_pop(T& datum) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Cell &cell = cells[pos & mask];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (seq != pos + 1)
+            return false;
+        datum = std::move(cell.data);
+        cell.data = T();
+        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+        tail.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Check for a poppable element. Only the consumer thread may call this.
+     * @return  true if try_pop would fail right now
+     */
+    bool empty() const {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        return cells[pos & mask].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+private:
+    static const size_t CACHE_LINE = 64;
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    Cell *cells;
+    size_t mask;
+    alignas(CACHE_LINE) std::atomic<size_t> head;  // next slot for producers
+    alignas(CACHE_LINE) std::atomic<size_t> tail;  // next slot for the consumer
+};
@@ -8,52 +8,6 @@
 using namespace std;
 
 
-void NewsFeed::bubble(size_t child) {
-    while (!is_root(child) && value(child) < value(parent(child))) {
-      size_t p = parent(child);
-      swap(child, p);
-      child = p;
-    }
-}
-
-void NewsFeed::percolate(size_t p) {
-    while (!is_leaf(p)) {
-      size_t child = left(p);
-      if (has_right(p) && value(right(p)) < value(child))
-        child = right(p);
-      if (value(p) <= value(child))
-        return;
-      swap(child, p);
-      p = child;
-    }
-}
- 
-NewsFeed::Staleness NewsFeed::value(size_t i) const {
-    return weight(heap[i]);
-}
-
-void NewsFeed::swap(size_t i, size_t j) {
-    std::swap(heap[i], heap[j]);
-    locations.add(heap[i], i);
-    locations.add(heap[j], j);
-}
-
-bool NewsFeed::valid(size_t i) const {
-    return i <= n && i >= root();
-}
-
-bool NewsFeed::is_root(size_t i) const {
-    return i == root();
-}
-
-bool NewsFeed::is_leaf(size_t i) const {
-    return !valid(left(i));
-}
-
-bool NewsFeed::has_right(size_t p) const {
-    return valid(right(p));
-}
-
 void NewsFeed::resize() {
     NewsFeed::Headline *oldheap = heap;
     capacity = 2*capacity + 17;
@@ -63,20 +17,16 @@ void NewsFeed::resize() {
     delete[] oldheap;
 }
 
-size_t NewsFeed::root() {
-    return 1;
-}
-
-size_t NewsFeed::parent(size_t child) {
-    return child/2;
-}
-
-size_t NewsFeed::left(size_t p) {
-    return p*2;
-}
-
-size_t NewsFeed::right(size_t p) {
-    return left(p)+1;
+void NewsFeed::place(const NewsFeed::Update &update) {
+    if (update.fresh)
+      stories.add(update.headline, update.story);
+    staleness.add(update.headline, update.staleness);
+    if (update.fresh && !has(update.headline)) {
+      if (n == capacity)
+        resize();
+      heap[++n] = update.headline;
+      locations.add(update.headline, n);
+    }
 }
 
 NewsFeed::NewsFeed() : heap(nullptr), n(0), capacity(0) {}
@@ -91,11 +41,16 @@ NewsFeed& NewsFeed::operator =(const NewsFeed &other) = delete;
 NewsFeed& NewsFeed::operator =(NewsFeed &&temp) = delete;
 
 void NewsFeed::enqueue(NewsFeed::Headline headline, NewsFeed::Story story, NewsFeed::Staleness weight) {
+    if (has(headline)) {
+      stories.add(headline, story);
+      reweight(headline, weight);
+      return;
+    }
     if (n == capacity)
       resize();
     stories.add(headline, story);
     staleness.add(headline, weight);
-    locations.add(headline,n);
+    locations.add(headline,n+1);
     heap[++n] = headline;
     bubble(n);
 }
@@ -137,6 +92,47 @@ void NewsFeed::reweight(NewsFeed::Headline headline, NewsFeed::Staleness newWeig
     locations.add(headline,i);
 }
 
+bool NewsFeed::has(NewsFeed::Headline headline) const {
+    if (!locations.has(headline))
+      return false;
+    const auto &map = locations;
+    size_t loc = map.get(headline);
+    return valid(loc) && heap[loc] == headline;  // dequeued headlines keep a stale location
+}
+
+void NewsFeed::apply(const std::vector<NewsFeed::Update> &batch) {
+    // a reweight is fine if its headline is in the feed or enqueued earlier in the batch
+    DictHash<Headline, bool, HeadlineHasher> queued;
+    for (const Update &update : batch) {
+      if (update.fresh)
+        queued.add(update.headline, true);
+      else if (!queued.has(update.headline) && !has(update.headline))
+        throw std::invalid_argument("reweight of headline not in feed");
+    }
+    apply_unchecked(batch);
+}
+
+void NewsFeed::apply_unchecked(const std::vector<NewsFeed::Update> &batch) {
+
+    // Sifting each update costs about k*log(n); rebuilding the whole heap costs about 2n.
+    size_t total = n + batch.size();
+    size_t depth = 1;
+    while ((total >> depth) != 0)
+      depth++;
+    if (batch.size() * depth < 2 * total) {
+      for (const Update &update : batch) {
+        place(update);
+        size_t loc = locations.get(update.headline);
+        bubble(loc);
+        percolate(locations.get(update.headline));
+      }
+    } else {
+      for (const Update &update : batch)
+        place(update);
+      heapify();
+    }
+}
+
 NewsFeed::Story NewsFeed::get(NewsFeed::Headline headline) const {
     const auto &theHeap = stories;  // force using the const version of the DictHash::get() method
     return theHeap.get(headline);
@@ -6,18 +6,33 @@
 
 #include <iostream>
 #include "DictHash.h"
+#include "FeedHeap.h"
+#include "StringHash.h"
 #include <string>
+#include <vector>
 #include "adt/PriorityQueue.h"
 #pragma once
 
-class NewsFeed {
+class NewsFeed : private FeedHeap<NewsFeed> {
  public:
   typedef std::string Headline;
   typedef std::string Story;
   typedef int Staleness;
-  typedef std::hash<std::string> HeadlineHasher;
+  typedef StringHash HeadlineHasher;
   typedef DictHash<Headline,Story,HeadlineHasher>::const_iterator const_iterator;
 
+  /**
+   * One pending change for apply(): an enqueue (fresh) or a reweight.
+   * As with enqueue(), a fresh update for a headline already in the feed
+   * replaces its story and staleness rather than adding it twice.
+   */
+  struct Update {
+    Headline headline;
+    Story story;          // only used when fresh
+    Staleness staleness;
+    bool fresh;
+  };
+
   NewsFeed();
   ~NewsFeed();
   NewsFeed(const NewsFeed &other);
@@ -30,27 +45,25 @@ class NewsFeed {
   bool empty() const;
   Staleness weight(Headline headline) const;
   void reweight(Headline headline, Staleness staleness);
+  bool has(Headline headline) const;
+  /**
+   * Apply the updates in the order given.
+   * Throws invalid_argument, before changing anything, if a reweight names a
+   * headline that is neither in the feed nor enqueued earlier in the batch.
+   */
+  void apply(const std::vector<Update> &batch);
   Story get(Headline headline) const;
   const_iterator begin() const;
   const_iterator end() const;
   
  private:
+  friend class FeedHeap<NewsFeed>;  // sifts heap[] and keeps locations up to date
+  friend class NewsFeedIngest;      // validates its batches itself, then calls apply_unchecked
   typedef size_t HeapLocation;
 
-  void bubble(size_t child);
-  void percolate(size_t p);
-  Staleness value(size_t i) const;
-  void swap(size_t i, size_t j);
-  bool valid(size_t i) const;
-  bool is_root(size_t i) const;
-  bool is_leaf(size_t i) const;
-  bool has_right(size_t p) const;
   void resize();
-  
-  static size_t root();
-  static size_t parent(size_t child);
-  static size_t left(size_t p);
-  static size_t right(size_t p);
+  void place(const Update &update);
+  void apply_unchecked(const std::vector<Update> &batch);
 
   DictHash<Headline, Story, HeadlineHasher> stories;
   DictHash<Headline, Staleness, HeadlineHasher> staleness;
@@ -0,0 +1,188 @@
+/**
+ * @file NewsFeedIngest.cpp - Implementation of NewsFeedIngest.h
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC2430, Spring 2018"
+ */
+
+#include <memory>
+#include <stdexcept>
+#include "NewsFeedIngest.h"
+using namespace std;
+
+
+NewsFeedIngest::NewsFeedIngest(NewsFeed &feed, size_t capacity, size_t maxBatch)
+    : feed(feed), queue(capacity), maxBatch(maxBatch), running(true), parked(false) {
+    if (maxBatch == 0)
+      throw invalid_argument("maxBatch must be at least 1");
+    batch.reserve(maxBatch);
+    writer = thread(&NewsFeedIngest::drain, this);
+}
+
+NewsFeedIngest::~NewsFeedIngest() {
+    running.store(false, memory_order_release);
+    {
+      lock_guard<mutex> guard(parkLock);
+      parked.store(false, memory_order_relaxed);
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+pair<NewsFeedIngest::Callback, future<void>> NewsFeedIngest::completion() {
+    auto promised = make_shared<promise<void>>();
+    future<void> result = promised->get_future();
+    Callback done = [promised](exception_ptr error) {
+        if (error)
+          promised->set_exception(error);
+        else
+          promised->set_value();
+    };
+    return make_pair(std::move(done), std::move(result));
+}
+
+future<void> NewsFeedIngest::enqueue(NewsFeed::Headline headline, NewsFeed::Story story,
+                                     NewsFeed::Staleness staleness) {
+    auto pending = completion();
+    enqueue(std::move(headline), std::move(story), staleness, std::move(pending.first));
+    return std::move(pending.second);
+}
+
+void NewsFeedIngest::enqueue(NewsFeed::Headline headline, NewsFeed::Story story,
+                             NewsFeed::Staleness staleness, Callback done) {
+    submit(Request{NewsFeed::Update{std::move(headline), std::move(story), staleness, true},
+                   std::move(done)});
+}
+
+future<void> NewsFeedIngest::reweight(NewsFeed::Headline headline, NewsFeed::Staleness staleness) {
+    auto pending = completion();
+    reweight(std::move(headline), staleness, std::move(pending.first));
+    return std::move(pending.second);
+}
+
+void NewsFeedIngest::reweight(NewsFeed::Headline headline, NewsFeed::Staleness staleness,
+                              Callback done) {
+    submit(Request{NewsFeed::Update{std::move(headline), NewsFeed::Story(), staleness, false},
+                   std::move(done)});
+}
+
+void NewsFeedIngest::submit(NewsFeedIngest::Request &&request) {
+    while (!queue.try_push(std::move(request)))
+      this_thread::yield();  // ring is full: wait for the writer to catch up
+
+    // Pairs with the fence in park(): either we see parked, or the writer sees our request.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (parked.load(memory_order_relaxed)) {
+      {
+        lock_guard<mutex> guard(parkLock);
+        parked.store(false, memory_order_relaxed);
+      }
+      wake.notify_one();
+    }
+}
+
+void NewsFeedIngest::drain() {
+    Request request;
+    int idle = 0;
+    for (;;) {
+      // Read the flag before popping: anything pushed before the destructor
+      // cleared it is then visible to the pops below, so nothing is left behind.
+      bool stopping = !running.load(memory_order_acquire);
+      while (batch.size() < maxBatch && queue.try_pop(request))
+        batch.push_back(std::move(request));
+      if (!batch.empty()) {
+        applyBatch();
+        batch.clear();
+        idle = 0;
+      } else if (stopping) {
+        return;
+      } else if (++idle < 64) {
+        this_thread::yield();
+      } else {
+        park();
+        idle = 0;
+      }
+    }
+}
+
+void NewsFeedIngest::park() {
+    unique_lock<mutex> lock(parkLock);
+    parked.store(true, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (queue.empty() && running.load(memory_order_acquire))
+      wake.wait(lock, [this]() { return !parked.load(memory_order_relaxed); });
+    parked.store(false, memory_order_relaxed);
+}
+
+void NewsFeedIngest::applyBatch() {
+    // Fold all requests for the same headline into one update. A reweight keeps
+    // an earlier enqueue fresh; a later enqueue replaces whatever came before.
+    // A reweight with no earlier enqueue in the batch is "unanchored": it only
+    // succeeds if the headline is already in the feed, checked below under the lock.
+    slotOf.clear();
+    updates.clear();
+    slots.clear();
+    waiters.clear();
+    for (Request &request : batch) {
+      NewsFeed::Update &update = request.update;
+      bool fresh = update.fresh;
+      size_t slot;
+      if (slotOf.has(update.headline)) {
+        slot = slotOf.get(update.headline);
+        if (fresh)
+          updates[slot] = std::move(update);
+        else
+          updates[slot].staleness = update.staleness;
+      } else {
+        slot = updates.size();
+        slotOf.add(update.headline, slot);
+        updates.push_back(std::move(update));
+        slots.push_back(Slot{false, false, false});
+      }
+      bool unanchored = !fresh && !slots[slot].anchored;
+      waiters.push_back(Waiter{std::move(request.done), slot, unanchored});
+      if (fresh)
+        slots[slot].anchored = true;
+      if (unanchored)
+        slots[slot].orphaned = true;
+    }
+
+    exception_ptr failure;
+    {
+      lock_guard<mutex> guard(feedLock);
+      size_t kept = 0;
+      for (size_t i = 0; i < updates.size(); i++) {
+        if (slots[i].orphaned && !feed.has(updates[i].headline)) {
+          slots[i].missing = true;
+          if (!updates[i].fresh)
+            continue;  // nothing left to apply for this headline
+        }
+        if (kept != i)
+          updates[kept] = std::move(updates[i]);
+        kept++;
+      }
+      updates.resize(kept);
+      try {
+        feed.apply_unchecked(updates);
+      } catch (...) {
+        failure = current_exception();
+      }
+    }
+
+    exception_ptr missing;
+    for (Waiter &waiter : waiters) {
+      if (!waiter.done)
+        continue;
+      exception_ptr error = failure;
+      if (waiter.unanchored && slots[waiter.slot].missing) {
+        if (!missing)
+          missing = make_exception_ptr(invalid_argument("reweight of headline not in feed"));
+        error = missing;
+      }
+      try {
+        waiter.done(error);
+      } catch (...) {
+        // a throwing callback must not take down the writer thread
+      }
+    }
+    waiters.clear();  // let go of the callbacks (and their promises) now
+}
@@ -0,0 +1,107 @@
+/**
+ * @file NewsFeedIngest.h - Concurrent ingest front end for a NewsFeed
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC2430, Spring 2018"
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "MPSCQueue.h"
+#include "NewsFeed.h"
+
+/**
+ * @class NewsFeedIngest - lets many editor threads update one NewsFeed
+ *
+ * Editors push enqueue and reweight requests onto a lock-free ring buffer.
+ * A single writer thread drains it in batches, folds repeated changes to the
+ * same headline into one, and applies each batch with NewsFeed::apply under
+ * one lock acquisition. Readers go through access() to share that lock.
+ *
+ * Completion callbacks run on the writer thread with a null exception_ptr on
+ * success. They should be quick and should not throw; anything they throw is
+ * discarded. A reweight fails with invalid_argument unless its headline is in
+ * the feed or was enqueued earlier, no matter how the requests get batched.
+ * Destroying the ingest applies every request already submitted.
+ * An idle writer parks on a condition variable until the next request.
+ */
+class NewsFeedIngest {
+ public:
+  typedef std::function<void(std::exception_ptr)> Callback;
+
+  /**
+   * Start the writer thread.
+   * @param feed      feed to update; the ingest must not outlive it
+   * @param capacity  ring buffer slots (rounded up to a power of two)
+   * @param maxBatch  most requests applied per lock acquisition
+   * @throws          invalid_argument if maxBatch is 0
+   */
+  NewsFeedIngest(NewsFeed &feed, size_t capacity = 4096, size_t maxBatch = 256);
+  ~NewsFeedIngest();
+  NewsFeedIngest(const NewsFeedIngest &other) = delete;
+  NewsFeedIngest& operator =(const NewsFeedIngest &other) = delete;
+
+  std::future<void> enqueue(NewsFeed::Headline headline, NewsFeed::Story story,
+                            NewsFeed::Staleness staleness);
+  void enqueue(NewsFeed::Headline headline, NewsFeed::Story story,
+               NewsFeed::Staleness staleness, Callback done);
+  std::future<void> reweight(NewsFeed::Headline headline, NewsFeed::Staleness staleness);
+  void reweight(NewsFeed::Headline headline, NewsFeed::Staleness staleness, Callback done);
+
+  /**
+   * Run f(feed) while holding the feed lock, e.g. to peek or dequeue.
+   * @param f  callable taking NewsFeed&
+   */
+  template <typename F>
+  void access(F f) {
+    std::lock_guard<std::mutex> guard(feedLock);
+    f(feed);
+  }
+
+ private:
+  struct Request {
+    NewsFeed::Update update;
+    Callback done;
+  };
+  struct Slot {            // per distinct headline in a batch
+    bool anchored;         // an enqueue for it has been seen
+    bool orphaned;         // a reweight came before any enqueue
+    bool missing;          // ...and the headline was not in the feed
+  };
+  struct Waiter {          // per request in a batch
+    Callback done;
+    size_t slot;
+    bool unanchored;       // reweight with no earlier enqueue in the batch
+  };
+
+  static std::pair<Callback, std::future<void>> completion();
+  void submit(Request &&request);
+  void drain();
+  void park();
+  void applyBatch();
+
+  NewsFeed &feed;
+  std::mutex feedLock;
+  MPSCQueue<Request> queue;
+  size_t maxBatch;
+  std::atomic<bool> running;
+  std::atomic<bool> parked;
+  std::mutex parkLock;
+  std::condition_variable wake;
+
+  // writer-only scratch space, cleared and reused for every batch
+  std::vector<Request> batch;
+  DictHash<NewsFeed::Headline, size_t, NewsFeed::HeadlineHasher> slotOf;
+  std::vector<NewsFeed::Update> updates;
+  std::vector<Slot> slots;
+  std::vector<Waiter> waiters;
+
+  std::thread writer;
+};
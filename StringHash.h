@@ -0,0 +1,74 @@
+/**
+ * @file StringHash.h - Fast string hasher for DictHash
+ * @author Rajiv Singireddy
+ * @see "Seattle University, CPSC2430, Spring 2018"
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * @class StringHash - word-at-a-time string hasher
+ *
+ * Follows the xxHash64 layout: 32-byte stripes go through four independent
+ * multiply-rotate lanes (which the compiler can keep in separate registers or
+ * vector lanes), the tail is folded in 8 bytes and then 1 byte at a time, and
+ * a final avalanche spreads every input bit into the low bits that DictHash
+ * masks with. Drop-in replacement for std::hash<std::string>.
+ */
+struct StringHash {
+    size_t operator()(const std::string &s) const {
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(s.data());
+        const unsigned char *end = p + s.size();
+        uint64_t h;
+
+        if (s.size() >= 32) {
+            uint64_t lane[4] = {SEED + P1 + P2, SEED + P2, SEED, SEED - P1};
+            for (; p + 32 <= end; p += 32)
+                for (int i = 0; i < 4; i++)
+                    lane[i] = round(lane[i], load(p + 8*i));
+            h = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18);
+            for (int i = 0; i < 4; i++)
+                h = (h ^ round(0, lane[i])) * P1 + P4;
+        } else {
+            h = SEED + P5;
+        }
+        h += s.size();
+
+        for (; p + 8 <= end; p += 8)
+            h = rotl(h ^ round(0, load(p)), 27) * P1 + P4;
+        for (; p < end; p++)
+            h = rotl(h ^ (*p * P5), 11) * P1;
+
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+        return static_cast<size_t>(h);
+    }
+
+private:
+    static const uint64_t P1 = 0x9E3779B185EBCA87ULL;
+    static const uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+    static const uint64_t P3 = 0x165667B19E3779F9ULL;
+    static const uint64_t P4 = 0x85EBCA77C2B2AE63ULL;
+    static const uint64_t P5 = 0x27D4EB2F165667C5ULL;
+    static const uint64_t SEED = 0;
+
+    static uint64_t rotl(uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    static uint64_t round(uint64_t acc, uint64_t input) {
+        return rotl(acc + input * P2, 31) * P1;
+    }
+
+    static uint64_t load(const unsigned char *p) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));  // unaligned-safe; compiles to one load
+        return word;
+    }
+};
@@ -4,10 +4,26 @@
  * @see "Seattle University, CPSC2430, Spring 2018"
  */
 
+#include <chrono>
 #include <iostream>
+#include <thread>
+#include <vector>
+#include "FixedNewsFeed.h"
 #include "NewsFeed.h"
+#include "NewsFeedIngest.h"
 using namespace std;
 
+/**
+ * Hasher that crowds keys into two overlapping probe runs: keys below 50 hash to 0
+ * (home bucket 0), the rest hash to 8 (home bucket 15, the last of 16 buckets,
+ * so that run wraps around into bucket 0 and beyond).
+ */
+struct Crowded {
+    size_t operator()(int key) const {
+        return key < 50 ? 0 : 8;
+    }
+};
+
 int main() {
     NewsFeed feed;
     cout << "Some initial tests:" << endl;
@@ -37,5 +53,87 @@ int main() {
     feed.dequeue();
     cout << feed.empty() << " (expect true)" << endl << endl;
 
+    cout << "Concurrent editors:" << endl;
+    {
+        NewsFeedIngest ingest(feed);
+        vector<thread> editors;
+        for (int e = 0; e < 4; e++)
+            editors.push_back(thread([&ingest, e]() {
+                for (int i = 0; i < 100; i++) {
+                    string headline = "E" + to_string(e) + "-" + to_string(i);
+                    ingest.enqueue(headline, "story", 1000 + i);
+                    ingest.reweight(headline, e * 100 + i);
+                }
+            }));
+        for (thread &editor : editors)
+            editor.join();
+        ingest.reweight("E3-99", -5).get();
+        try {
+            ingest.reweight("nobody", 1).get();
+        } catch (const invalid_argument &) {
+            cout << "reweight of missing headline rejected (expect this)" << endl;
+        }
+        ingest.access([](NewsFeed &f) {
+            cout << "peek:  '" << f.peek() << "' (expect E3-99)" << endl;
+            f.dequeue();
+            cout << "peek:  '" << f.peek() << "' (expect E0-0)" << endl;
+            int count = 1, last = -10;
+            bool ordered = true;
+            for (; !f.empty(); f.dequeue(), count++) {
+                ordered = ordered && last <= f.weight(f.peek());
+                last = f.weight(f.peek());
+            }
+            cout << count << " dequeued in order: " << ordered << " (expect 400 1)" << endl;
+        });
+    }
+
+    cout << endl << "Fixed-capacity breaking news:" << endl;
+    FixedNewsFeed<4> breaking;
+    breaking.enqueue("Quake", "ground shakes", 3);
+    breaking.enqueue("Storm", "wind blows", 2);
+    breaking.enqueue("Fire", "smoke rises", 5);
+    breaking.enqueue("Flood", "water rises", 4);
+    try {
+        breaking.enqueue("Drought", "nothing rises", 1);
+    } catch (const length_error &) {
+        cout << "enqueue into full feed rejected (expect this)" << endl;
+    }
+    breaking.reweight("Fire", 1);
+    cout << "peek:  '" << breaking.peek() << "' (expect Fire)" << endl;
+    breaking.dequeue();
+    breaking.enqueue("Drought", "nothing rises", 0);
+    cout << "peek:  '" << breaking.peek() << "' (expect Drought)" << endl;
+    cout << "story: '" << breaking.get(breaking.peek()) << "'" << endl;
+
+    cout << endl << "Removing from the middle of a collision run:" << endl;
+    DictHash<int,int,Crowded,8> crowded;
+    for (int key : {80, 81, 1, 82, 2, 83, 3})
+        crowded.add(key, key * 10);
+    crowded.remove(82);
+    crowded.remove(1);
+    bool intact = true;
+    for (int key : {80, 81, 2, 83, 3})
+        intact = intact && crowded.has(key) && crowded.get(key) == key * 10;
+    cout << "others intact: " << intact << " (expect 1)" << endl;
+    cout << "removed gone:  " << (crowded.has(82) || crowded.has(1)) << " (expect 0)" << endl;
+    crowded.add(84, 840);
+    crowded.add(4, 40);
+    cout << "refilled:      " << (crowded.get(84) == 840 && crowded.get(4) == 40 && crowded.has(83))
+         << " (expect 1)" << endl;
+
+    cout << endl << "Strided integer keys (identity std::hash):" << endl;
+    for (int shift : {12, 40, 48}) {
+        DictHash<long,int> strided;
+        auto start = chrono::steady_clock::now();
+        for (long i = 0; i < 20000; i++)
+            strided.add(i << shift, 1);
+        long found = 0;
+        for (long i = 0; i < 20000; i++)
+            found += strided.has(i << shift);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "i<<" << shift << ": found " << found << " (expect 20000) in "
+             << ms << " ms (expect a few ms, not hundreds)" << endl;
+    }
+
     return 0;
 }